@@ -0,0 +1,19 @@
+#!/bin/bash
+
+# builds the trace target and the host converter,
+# runs the target under qemu and converts its semihosting output into trace.json
+
+set -e
+
+BUILD=${BUILD:-build}
+ELF=${ELF:-$BUILD/trace.elf}
+QEMU=${QEMU:-"qemu-system-arm -M netduinoplus2 -nographic -monitor none -serial null"}
+
+cmake -S. -B$BUILD
+cmake --build $BUILD --target trace
+c++ -std=c++17 -O2 -o $BUILD/trace2json trace/trace2json.cpp
+
+timeout 60 $QEMU -semihosting-config enable=on,target=native -kernel $ELF > $BUILD/trace.txt
+$BUILD/trace2json $BUILD/trace.txt > trace.json
+
+echo trace.json
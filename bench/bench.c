@@ -0,0 +1,35 @@
+#include <stm32f4_discovery.h>
+#include "bench.h"
+
+static bool     dwt;
+static uint32_t cycles;
+
+void bench_init( void )
+{
+	dwt = host_cycles();
+}
+
+cnt_t bench_begin( void )
+{
+	cnt_t now = sys_time();
+	while (sys_time() == now); // start the measurement at the tick edge
+	now = sys_time();
+	cycles = DWT->CYCCNT;
+	return now;
+}
+
+void bench_end( const char *name, unsigned param, unsigned ops, cnt_t start )
+{
+	unsigned long long count = (uint32_t)(DWT->CYCCNT - cycles);
+	unsigned long      ticks = (unsigned long)(sys_time() - start);
+	if (ticks == 0) ticks = 1;
+
+	// the number of cycles is derived from the system time
+	// if the cycle counter is not running or could have wrapped around
+	if (!dwt || ticks >= UINT32_MAX / (CPU_FREQUENCY / OS_FREQUENCY))
+		count = (unsigned long long)ticks * (CPU_FREQUENCY / OS_FREQUENCY);
+
+	host_print("%s,%u,%u,%lu,%lu,%lu\n", name, param, ops, ticks,
+	            (unsigned long)((unsigned long long)ops * OS_FREQUENCY / ticks),
+	            (unsigned long)(count / ops));
+}
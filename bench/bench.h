@@ -0,0 +1,25 @@
+#pragma once
+
+#include <os.h>
+#include "host.h"
+
+// number of iterations of every measured operation
+#ifndef BENCH_LOOPS
+#define BENCH_LOOPS 10000
+#endif
+
+// every result is printed as a single csv line:
+// bench,param,ops,ticks,ops/s,cycles/op
+// cycles/op is measured with the DWT cycle counter, if it is running
+
+void  bench_init ( void );
+
+cnt_t bench_begin( void );
+void  bench_end  ( const char *name, unsigned param, unsigned ops, cnt_t start );
+
+void  bench_lock ( void );
+void  bench_ipc  ( void );
+void  bench_cond ( void );
+void  bench_timer( void );
+void  bench_heap ( void );
+void  bench_sched( void );
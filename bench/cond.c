@@ -0,0 +1,62 @@
+#include "bench.h"
+
+// broadcast to the growing number of tasks waiting for the condition variable
+// every woken task has to reacquire the mutex before the next broadcast
+
+#define COND_STEPS       3
+#define COND_WAITERS    16
+
+static const unsigned waiters[COND_STEPS] = { 1, 4, COND_WAITERS };
+
+static tsk_t tsk[COND_WAITERS];
+static stk_t stk[COND_WAITERS][STK_SIZE(256)];
+
+OS_MTX(cond_mtx);
+OS_CND(cond_cnd);
+OS_SEM(cond_all, 0);
+
+static unsigned rounds;
+static unsigned woken;
+static unsigned count;
+
+static void waiter( void )
+{
+	mtx_wait(cond_mtx);
+	for (unsigned r = 0; r < rounds; r++)
+	{
+		cnd_wait(cond_cnd, cond_mtx);
+		if (++woken == count)
+			sem_give(cond_all);
+	}
+	mtx_give(cond_mtx);
+	tsk_stop();
+}
+
+void bench_cond()
+{
+	cnt_t start;
+
+	for (unsigned i = 0; i < COND_WAITERS; i++)
+		wrk_init(&tsk[i], waiter, stk[i], sizeof(stk[i]));
+
+	for (unsigned step = 0; step < COND_STEPS; step++)
+	{
+		count  = waiters[step];
+		rounds = BENCH_LOOPS / count;
+
+		for (unsigned i = 0; i < count; i++)
+			tsk_start(&tsk[i]);
+		tsk_yield(); // let all the waiters wait for the condition variable
+
+		start = bench_begin();
+		for (unsigned r = 0; r < rounds; r++)
+		{
+			woken = 0;
+			mtx_wait(cond_mtx);
+			cnd_give(cond_cnd, cndAll);
+			mtx_give(cond_mtx);
+			sem_wait(cond_all);
+		}
+		bench_end("cnd_give(all)", count, rounds * count, start);
+	}
+}
@@ -0,0 +1,37 @@
+#include "bench.h"
+
+// blocks of mixed sizes are freed and allocated again in random order
+// through the system heap, the same way objects are created and destroyed by the application
+
+#define HEAP_LOOPS    (BENCH_LOOPS * 100)
+#define HEAP_BLOCKS   64
+#define HEAP_SIZE    256
+
+static void *blk[HEAP_BLOCKS];
+
+static unsigned randomize( unsigned *seed )
+{
+	*seed = *seed * 1103515245U + 12345U;
+	return *seed >> 16;
+}
+
+void bench_heap()
+{
+	unsigned seed = 1;
+	cnt_t start;
+
+	for (unsigned i = 0; i < HEAP_BLOCKS; i++)
+		blk[i] = sys_alloc(8 + randomize(&seed) % HEAP_SIZE);
+
+	start = bench_begin();
+	for (unsigned i = 0; i < HEAP_LOOPS; i++)
+	{
+		unsigned n = randomize(&seed) % HEAP_BLOCKS;
+		sys_free(blk[n]);
+		blk[n] = sys_alloc(8 + randomize(&seed) % HEAP_SIZE);
+	}
+	bench_end("sys_free+alloc", HEAP_BLOCKS, HEAP_LOOPS, start);
+
+	for (unsigned i = 0; i < HEAP_BLOCKS; i++)
+		sys_free(blk[i]);
+}
@@ -0,0 +1,234 @@
+#include <string.h>
+#include "bench.h"
+
+// every peer task serves exactly BENCH_LOOPS requests, gives ipc_done and stops;
+// the next scenario starts the peer again only after it has taken ipc_done
+
+#define IPC_LIMIT       16
+#define IPC_FRAME      256
+
+static const size_t frames[] = { sizeof(unsigned), 64, IPC_FRAME };
+
+OS_SEM(ipc_done, 0);
+OS_SEM(ipc_ping, 0);
+OS_SEM(ipc_pong, 0);
+OS_MSG(ipc_req,  1, IPC_FRAME);
+OS_MSG(ipc_rsp,  1, IPC_FRAME);
+OS_MSG(ipc_msg,  IPC_LIMIT, IPC_FRAME);
+OS_MEM(ipc_mem,  IPC_LIMIT, IPC_FRAME);
+OS_LST(ipc_lst);
+OS_EVQ(ipc_evq,  IPC_LIMIT);
+OS_BOX(ipc_box,  IPC_LIMIT, sizeof(unsigned));
+OS_JOB(ipc_job,  IPC_LIMIT);
+
+static size_t frame;
+
+static void nop( void )
+{
+}
+
+OS_TMR(ipc_tmr,  nop);
+
+static void yielder( void )
+{
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		tsk_yield();
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+static void semaphore( void )
+{
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		sem_wait(ipc_ping);
+		sem_give(ipc_pong);
+	}
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+static void message( void )
+{
+	char buf[IPC_FRAME];
+
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		msg_wait(ipc_req, buf, frame, NULL);
+		msg_give(ipc_rsp, buf, frame);
+	}
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+// the frame is copied into the queue and out of it
+static void copy( void )
+{
+	char buf[IPC_FRAME];
+
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		msg_wait(ipc_msg, buf, IPC_FRAME, NULL);
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+// the frame is written in place by the producer and read in place
+static void loan( void )
+{
+	void *p;
+
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		lst_wait(ipc_lst, &p);
+		mem_give(ipc_mem, p);
+	}
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+static void event( void )
+{
+	unsigned x;
+
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		evq_wait(ipc_evq, &x);
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+// all pending events are taken in one wakeup
+static void drain( void )
+{
+	unsigned x;
+
+	for (unsigned n = 0; n < BENCH_LOOPS; )
+	{
+		evq_wait(ipc_evq, &x);
+		for (n++; evq_take(ipc_evq, &x) == E_SUCCESS; n++);
+		sem_give(ipc_pong);
+	}
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+static void mailbox( void )
+{
+	unsigned x;
+
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		box_wait(ipc_box, &x);
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+static void job( void )
+{
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		job_wait(ipc_job);
+	sem_give(ipc_done);
+	tsk_stop();
+}
+
+OS_TSK(ipc_peer, NULL, 512);
+
+void bench_ipc()
+{
+	char buf[IPC_FRAME] = { 0 };
+	cnt_t start;
+
+	tsk_startFrom(ipc_peer, yielder);
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		tsk_yield();
+	bench_end("tsk_switch", 2, BENCH_LOOPS * 2, start);
+	sem_wait(ipc_done);
+
+	tsk_startFrom(ipc_peer, semaphore);
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		sem_give(ipc_ping);
+		sem_wait(ipc_pong);
+	}
+	bench_end("sem_give+wait", 0, BENCH_LOOPS, start);
+	sem_wait(ipc_done);
+
+	for (unsigned f = 0; f < sizeof(frames) / sizeof(*frames); f++)
+	{
+		frame = frames[f];
+		tsk_startFrom(ipc_peer, message);
+		start = bench_begin();
+		for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		{
+			msg_give(ipc_req, buf, frame);
+			msg_wait(ipc_rsp, buf, frame, NULL);
+		}
+		bench_end("msg_give+wait", frame, BENCH_LOOPS, start);
+		sem_wait(ipc_done);
+	}
+
+	tsk_startFrom(ipc_peer, copy);
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		memset(buf, i, IPC_FRAME);
+		msg_send(ipc_msg, buf, IPC_FRAME);
+	}
+	sem_wait(ipc_done);
+	bench_end("msg_send", IPC_FRAME, BENCH_LOOPS, start);
+
+	tsk_startFrom(ipc_peer, loan);
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		void *p;
+		mem_wait(ipc_mem, &p);
+		memset(p, i, IPC_FRAME);
+		lst_give(ipc_lst, p);
+	}
+	sem_wait(ipc_done);
+	bench_end("mem+lst_give", IPC_FRAME, BENCH_LOOPS, start);
+
+	tsk_startFrom(ipc_peer, event);
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		evq_send(ipc_evq, i);
+	sem_wait(ipc_done);
+	bench_end("evq_send", IPC_LIMIT, BENCH_LOOPS, start);
+
+	for (unsigned burst = 1; burst <= IPC_LIMIT; burst *= 4)
+	{
+		tsk_startFrom(ipc_peer, drain);
+		start = bench_begin();
+		for (unsigned i = 0; i < BENCH_LOOPS; i += burst)
+		{
+			for (unsigned j = 0; j < burst; j++)
+				evq_give(ipc_evq, j);
+			sem_wait(ipc_pong);
+		}
+		bench_end("evq_burst", burst, BENCH_LOOPS, start);
+		sem_wait(ipc_done);
+	}
+
+	tsk_startFrom(ipc_peer, mailbox);
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		box_send(ipc_box, &i);
+	sem_wait(ipc_done);
+	bench_end("box_send", IPC_LIMIT, BENCH_LOOPS, start);
+
+	tsk_startFrom(ipc_peer, job);
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		job_send(ipc_job, nop);
+	sem_wait(ipc_done);
+	bench_end("job_send", IPC_LIMIT, BENCH_LOOPS, start);
+
+	start = bench_begin();
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		tmr_startFor(ipc_tmr, 0);
+		tmr_wait(ipc_tmr);
+	}
+	bench_end("tmr_dispatch", 0, BENCH_LOOPS, start);
+}
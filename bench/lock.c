@@ -0,0 +1,44 @@
+#include "bench.h"
+
+// uncontended operations, nobody is waiting for the object
+
+#define LOCK_LOOPS  (BENCH_LOOPS * 100)
+
+OS_SEM(lock_sem, 0);
+OS_MTX(lock_mtx);
+OS_FLG(lock_flg, 0);
+OS_EVT(lock_evt);
+
+void bench_lock()
+{
+	cnt_t start;
+
+	start = bench_begin();
+	for (unsigned i = 0; i < LOCK_LOOPS; i++)
+	{
+		sem_give(lock_sem);
+		sem_take(lock_sem);
+	}
+	bench_end("sem_give+take", OS_ATOMICS, LOCK_LOOPS, start);
+
+	start = bench_begin();
+	for (unsigned i = 0; i < LOCK_LOOPS; i++)
+	{
+		mtx_wait(lock_mtx);
+		mtx_give(lock_mtx);
+	}
+	bench_end("mtx_wait+give", OS_ATOMICS, LOCK_LOOPS, start);
+
+	start = bench_begin();
+	for (unsigned i = 0; i < LOCK_LOOPS; i++)
+	{
+		flg_give(lock_flg, 1);
+		flg_take(lock_flg, 1, flgAll);
+	}
+	bench_end("flg_give+take", OS_ATOMICS, LOCK_LOOPS, start);
+
+	start = bench_begin();
+	for (unsigned i = 0; i < LOCK_LOOPS; i++)
+		evt_give(lock_evt, i);
+	bench_end("evt_give", OS_ATOMICS, LOCK_LOOPS, start);
+}
@@ -0,0 +1,16 @@
+#include "bench.h"
+
+int main()
+{
+	bench_init();
+	host_print("bench,param,ops,ticks,ops/s,cycles/op\n");
+
+	bench_lock();
+	bench_ipc();
+	bench_cond();
+	bench_timer();
+	bench_heap();
+	bench_sched(); // leaves the parked tasks behind, so it must be the last one
+
+	host_exit(0);
+}
@@ -0,0 +1,83 @@
+#include "bench.h"
+
+// the number of parked tasks and armed timers is increased step by step,
+// the cost of the scheduler operations should not depend on it
+
+#define SCHED_STEPS      4
+#define SCHED_TASKS     96
+#define SCHED_TIMERS   384
+
+static const unsigned tasks [SCHED_STEPS] = { 0, 4, 24, SCHED_TASKS  };
+static const unsigned timers[SCHED_STEPS] = { 0, 4, 96, SCHED_TIMERS };
+
+static tsk_t tsk[SCHED_TASKS];
+static stk_t stk[SCHED_TASKS][STK_SIZE(256)];
+static tmr_t tmr[SCHED_TIMERS];
+
+OS_SEM(sched_ping, 0);
+OS_SEM(sched_pong, 0);
+
+static void parked( void )
+{
+	tsk_sleep();
+}
+
+static void expired( void )
+{
+}
+
+static void peer( void )
+{
+	for (unsigned i = 0; i < BENCH_LOOPS; i++)
+	{
+		sem_wait(sched_ping);
+		sem_give(sched_pong);
+	}
+	tsk_stop();
+}
+
+OS_TSK(sched_peer, peer, 256);
+
+void bench_sched()
+{
+	unsigned nt = 0, nr = 0;
+	cnt_t start;
+
+	for (unsigned step = 0; step < SCHED_STEPS; step++)
+	{
+		for (; nt < tasks[step]; nt++)
+			tsk_init(&tsk[nt], parked, stk[nt], sizeof(stk[nt]));
+
+		for (; nr < timers[step]; nr++)
+		{
+			tmr_init(&tmr[nr], expired);
+			tmr_startPeriodic(&tmr[nr], 60*SEC);
+		}
+
+		tsk_yield(); // let the new tasks park
+
+		start = bench_begin();
+		for (unsigned i = 0; i < BENCH_LOOPS; i++)
+			tsk_yield();
+		bench_end("tsk_yield", nt + nr, BENCH_LOOPS, start);
+
+		start = bench_begin();
+		for (unsigned i = 0; i < BENCH_LOOPS; i++)
+			tsk_delay(0);
+		bench_end("tsk_delay", nt + nr, BENCH_LOOPS, start);
+
+		start = bench_begin();
+		for (unsigned i = 0; i < BENCH_LOOPS; i++)
+			tsk_sleepNext(0);
+		bench_end("tsk_sleepNext", nt + nr, BENCH_LOOPS, start);
+
+		tsk_start(sched_peer);
+		start = bench_begin();
+		for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		{
+			sem_give(sched_ping);
+			sem_wait(sched_pong);
+		}
+		bench_end("sem_handoff", nt + nr, BENCH_LOOPS * 2, start);
+	}
+}
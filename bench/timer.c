@@ -0,0 +1,51 @@
+#include "bench.h"
+
+// timers are armed with scattered delays and cancelled at once,
+// while the growing number of other timers remains armed
+
+#define TIMER_STEPS      3
+#define TIMER_ARMED    256
+
+static const unsigned armed[TIMER_STEPS] = { 0, 64, TIMER_ARMED };
+
+static tmr_t tmr[TIMER_ARMED];
+static tmr_t probe;
+
+static void expired( void )
+{
+}
+
+static cnt_t scatter( unsigned *seed )
+{
+	*seed = *seed * 1103515245U + 12345U;
+	return SEC + (cnt_t)((*seed >> 16) % (30*SEC));
+}
+
+void bench_timer()
+{
+	unsigned seed = 1;
+	unsigned n = 0;
+	cnt_t start;
+
+	tmr_init(&probe, expired);
+
+	for (unsigned step = 0; step < TIMER_STEPS; step++)
+	{
+		for (; n < armed[step]; n++)
+		{
+			tmr_init(&tmr[n], expired);
+			tmr_startFor(&tmr[n], scatter(&seed));
+		}
+
+		start = bench_begin();
+		for (unsigned i = 0; i < BENCH_LOOPS; i++)
+		{
+			tmr_startFor(&probe, scatter(&seed));
+			tmr_stop(&probe);
+		}
+		bench_end("tmr_start+stop", n, BENCH_LOOPS, start);
+	}
+
+	while (n > 0)
+		tmr_stop(&tmr[--n]);
+}
@@ -0,0 +1,177 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+#if !__cpp_impl_coroutine
+#error coroutines require c++20
+#endif
+
+#include <coroutine>
+#include <chrono>
+
+using namespace device;
+using namespace intros;
+using namespace std::chrono_literals;
+
+// coroutine frames are taken from the static pool, not from the heap
+template<size_t Size_, size_t Count_>
+struct FramePool
+{
+	static void *alloc( size_t size )
+	{
+		if (size <= Size_)
+			for (auto &frame: frames_)
+				if (!frame.used) { frame.used = true; return frame.data; }
+		return nullptr;
+	}
+
+	static void free( void *ptr )
+	{
+		for (auto &frame: frames_)
+			if (frame.data == ptr) { frame.used = false; return; }
+	}
+
+	private:
+	struct Frame { alignas(std::max_align_t) char data[Size_]; bool used; };
+	static inline Frame frames_[Count_] {};
+};
+
+using Pool = FramePool<256, 4>;
+
+struct Activity
+{
+	struct promise_type
+	{
+		static void *operator new( size_t size ) noexcept { return Pool::alloc(size); }
+		static void  operator delete( void *ptr ) { Pool::free(ptr); }
+		static Activity get_return_object_on_allocation_failure() { assert(false); return {}; }
+		Activity get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() {}
+	};
+};
+
+// all suspended coroutines are resumed by one task, on its stack
+struct Waiter
+{
+	bool (*ready)( Waiter * );
+	std::coroutine_handle<> handle = {};
+	Waiter *next = nullptr;
+
+	bool await_ready() { return ready(this); }
+	void await_suspend( std::coroutine_handle<> h );
+};
+
+struct Executor
+{
+	void suspend( Waiter *w )
+	{
+		w->next = list_;
+		list_ = w;
+	}
+
+	void run()
+	{
+		bool idle = true;
+		for (Waiter **p = &list_; *p != nullptr; )
+		{
+			Waiter *w = *p;
+			if (w->ready(w))
+			{
+				*p = w->next;
+				w->handle.resume();
+				idle = false;
+			}
+			else
+				p = &w->next;
+		}
+		if (idle)
+			thisTask::yield();
+	}
+
+	private:
+	Waiter *list_ = nullptr;
+};
+
+auto executor = Executor();
+
+void Waiter::await_suspend( std::coroutine_handle<> h )
+{
+	handle = h;
+	executor.suspend(this);
+}
+
+struct wait : Waiter
+{
+	wait( Semaphore &sem ): Waiter{check}, sem_{sem} {}
+	void await_resume() {}
+
+	private:
+	Semaphore &sem_;
+	static bool check( Waiter *w ) { return sem_take(&static_cast<wait *>(w)->sem_) == E_SUCCESS; }
+};
+
+template<unsigned limit_>
+struct receive : Waiter
+{
+	receive( EventQueueT<limit_> &evq ): Waiter{check}, evq_{evq} {}
+	unsigned await_resume() { return event_; }
+
+	private:
+	EventQueueT<limit_> &evq_;
+	unsigned event_;
+	static bool check( Waiter *w ) { auto r = static_cast<receive *>(w); return evq_take(&r->evq_, &r->event_) == E_SUCCESS; }
+};
+
+struct sleepFor : Waiter
+{
+	template<typename Rep_, typename Period_>
+	sleepFor( const std::chrono::duration<Rep_, Period_> &delay ): Waiter{check}, time_{Clock::now() + delay} {}
+	void await_resume() {}
+
+	private:
+	Clock::time_point time_;
+	static bool check( Waiter *w ) { return Clock::now() >= static_cast<sleepFor *>(w)->time_; }
+};
+
+auto led = Led();
+auto sem = Semaphore(0);
+auto evq = EventQueueT<1>();
+
+Activity producer()
+{
+	for (;;)
+	{
+		co_await sleepFor(1s);
+		sem.give();
+	}
+}
+
+Activity consumer()
+{
+	unsigned x = 1;
+
+	for (;;)
+	{
+		co_await wait(sem);
+		evq.give(x);
+		x = (x << 1) | (x >> 3);
+	}
+}
+
+Activity display()
+{
+	for (;;)
+		led = co_await receive(evq);
+}
+
+int main()
+{
+	producer();
+	consumer();
+	display();
+
+	for (;;)
+		executor.run();
+}
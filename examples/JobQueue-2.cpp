@@ -0,0 +1,53 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <new>
+#include <type_traits>
+
+using namespace device;
+using namespace intros;
+
+// callable object with the fixed capacity for the captured data
+// oversized captures fail at compile time, the heap is never used
+template<size_t size_>
+struct InplaceFunction
+{
+	InplaceFunction() = default;
+
+	template<class F>
+	InplaceFunction( F fun ): call_{invoke<F>}
+	{
+		static_assert(sizeof(F) <= size_, "captured data too big");
+		static_assert(alignof(F) <= alignof(std::max_align_t), "captured data overaligned");
+		static_assert(std::is_trivially_copyable_v<F>, "captured data must be trivially copyable");
+		new (data_) F(fun);
+	}
+
+	void operator()() { call_(data_); }
+
+	private:
+	template<class F>
+	static void invoke( void *data ) { (*std::launder(static_cast<F *>(data)))(); }
+
+	void (*call_)( void * ) = nullptr;
+	alignas(std::max_align_t) char data_[size_];
+};
+
+using Job = InplaceFunction<8>;
+
+auto led = Led();
+auto job = MessageQueueTT<1, Job>();
+auto cons = Task::Start([]{ Job fun; job.wait(&fun); fun(); });
+auto prod = Task::Start([]
+{
+	static unsigned x = 1;
+
+	thisTask::delay(SEC);
+	Job fun = [x = x]{ led = x; };
+	job.give(&fun);
+	x = (x << 1) | (x >> 3);
+});
+
+int main()
+{
+	thisTask::sleep();
+}
@@ -0,0 +1,153 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <mutex>
+
+using namespace device;
+using namespace intros;
+
+// count, min/max and log2 histogram of the times measured in cpu cycles
+struct Histogram
+{
+	void add( uint32_t time )
+	{
+		count++;
+		if (time < min) min = time;
+		if (time > max) max = time;
+		bucket[time ? 31 - __builtin_clz(time) : 0]++;
+	}
+
+	unsigned count       = 0;
+	uint32_t min         = UINT32_MAX;
+	uint32_t max         = 0;
+	unsigned bucket[32]  = {};
+};
+
+// the measured objects contain the kernel objects instead of deriving from them,
+// so a lock can't bypass the measurement by taking the base object (e.g. UniqueLock on a Mutex&)
+
+// mutex measuring the time of waiting for the lock and the time of holding it
+// it meets the requirements of std::lock_guard and std::unique_lock
+struct MeasuredMutex
+{
+	void lock()
+	{
+		uint32_t time = DWT->CYCCNT;
+		mtx_wait(&mtx_);
+		locked_ = DWT->CYCCNT;
+		waitTime.add(locked_ - time);
+	}
+
+	void unlock()
+	{
+		holdTime.add(DWT->CYCCNT - locked_);
+		mtx_give(&mtx_);
+	}
+
+	Histogram waitTime;
+	Histogram holdTime;
+
+	private:
+	Mutex    mtx_;
+	uint32_t locked_;
+};
+
+// read/write lock measuring the waits and the holds of the readers and the writers separately
+// every lock is held by its guard, which keeps the time of locking (there may be many readers)
+struct MeasuredRWLock
+{
+	template<bool write_>
+	struct Guard
+	{
+		~Guard()
+		{
+			hold_.add(DWT->CYCCNT - locked_);
+			if (write_) rwl_unlockWrite(rwl_); else rwl_unlockRead(rwl_);
+		}
+
+		rwl_t     *rwl_;
+		Histogram &hold_;
+		uint32_t   locked_;
+	};
+
+	Guard<false> read()
+	{
+		uint32_t time = DWT->CYCCNT;
+		rwl_lockRead(&rwl_);
+		uint32_t locked = DWT->CYCCNT;
+		readWait.add(locked - time);
+		return { &rwl_, readHold, locked };
+	}
+
+	Guard<true> write()
+	{
+		uint32_t time = DWT->CYCCNT;
+		rwl_lockWrite(&rwl_);
+		uint32_t locked = DWT->CYCCNT;
+		writeWait.add(locked - time);
+		return { &rwl_, writeHold, locked };
+	}
+
+	Histogram readWait;
+	Histogram readHold;
+	Histogram writeWait;
+	Histogram writeHold;
+
+	private:
+	RWLock rwl_;
+};
+
+// semaphore measuring the time of waiting for the token
+struct MeasuredSemaphore
+{
+	MeasuredSemaphore( unsigned init ): sem_{init} {}
+
+	unsigned wait()
+	{
+		uint32_t time = DWT->CYCCNT;
+		unsigned result = sem_wait(&sem_);
+		waitTime.add(DWT->CYCCNT - time);
+		return result;
+	}
+
+	unsigned give() { return sem_give(&sem_); }
+
+	Histogram waitTime;
+
+	private:
+	Semaphore sem_;
+};
+
+auto led = Led();
+auto mtx = MeasuredMutex();
+auto rwl = MeasuredRWLock();
+auto sem = MeasuredSemaphore(0);
+
+void consumer()
+{
+	sem.wait();
+	auto lock = std::lock_guard(mtx);
+	auto read = rwl.read();
+	led.tick();
+}
+
+void producer()
+{
+	{
+		auto lock = std::unique_lock(mtx);
+		auto write = rwl.write();
+		sem.give();
+		thisTask::sleepFor(SEC);
+	}
+	thisTask::yield();
+}
+
+auto prod = Task::Start(producer);
+auto cons = Task::Start(consumer);
+
+int main()
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	thisTask::sleep();
+}
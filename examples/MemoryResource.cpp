@@ -0,0 +1,93 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <memory_resource>
+#include <vector>
+
+using namespace device;
+using namespace intros;
+
+struct Stats { unsigned used, peak, fails; };
+
+// one size class: a memory pool of blocks of the same size
+template<size_t size_, unsigned limit_>
+struct Slab
+{
+	static constexpr size_t size = size_;
+
+	void *alloc()
+	{
+		Block *ptr;
+		if (pool_.take(&ptr) != E_SUCCESS) { stats.fails++; return nullptr; }
+		if (++stats.used > stats.peak) stats.peak = stats.used;
+		return ptr;
+	}
+
+	void free( void *ptr )
+	{
+		pool_.give(static_cast<Block *>(ptr));
+		stats.used--;
+	}
+
+	Stats stats {};
+
+	private:
+	struct alignas(std::max_align_t) Block { char data[size_]; };
+	MemoryPoolTT<limit_, Block> pool_;
+};
+
+// std::pmr containers draw from the deterministic pools instead of the heap
+struct SlabResource : public std::pmr::memory_resource
+{
+	Slab< 32, 16> small;
+	Slab< 64,  8> medium;
+	Slab<256,  4> large;
+
+	private:
+	void *do_allocate( size_t bytes, size_t align ) override
+	{
+		void *ptr = nullptr;
+		if (align <= alignof(std::max_align_t))
+		{
+			if      (bytes <= small.size)  ptr = small.alloc();
+			else if (bytes <= medium.size) ptr = medium.alloc();
+			else if (bytes <= large.size)  ptr = large.alloc();
+		}
+		return ptr ? ptr : std::pmr::null_memory_resource()->allocate(bytes, align);
+	}
+
+	void do_deallocate( void *ptr, size_t bytes, size_t ) override
+	{
+		if      (bytes <= small.size)  small.free(ptr);
+		else if (bytes <= medium.size) medium.free(ptr);
+		else                           large.free(ptr);
+	}
+
+	bool do_is_equal( const std::pmr::memory_resource &other ) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+auto led = Led();
+auto res = SlabResource();
+
+void proc()
+{
+	std::pmr::vector<unsigned> seq{&res};
+
+	for (unsigned x = 1; x < 16; x <<= 1)
+		seq.push_back(x);
+
+	for (auto x: seq)
+	{
+		thisTask::delay(SEC/4);
+		led = x;
+	}
+}
+
+auto tsk = Task::Start(proc);
+
+int main()
+{
+	thisTask::sleep();
+}
@@ -0,0 +1,161 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <utility>
+
+using namespace device;
+using namespace intros;
+
+// counters of the queue-like object:
+// peak fill level, producers that blocked or failed, consumers that found the object empty
+struct QueueStats
+{
+	unsigned level     = 0;
+	unsigned peak      = 0;
+	unsigned blocks    = 0; // send had to wait for a free space
+	unsigned overflows = 0; // give failed
+	unsigned empties   = 0; // take failed or wait had to wait for data
+
+	void in()  { if (++level > peak) peak = level; }
+	void out() { level--; }
+};
+
+// the same counters over any queue of the c++ wrapper:
+// EventQueueT, MessageQueueTT, MailBoxQueueTT, JobQueueT, RawBufferTT
+// the non-blocking call is tried first, so the blocking one is counted only when it really has to wait
+template<class Queue>
+struct Measured : public Queue, public QueueStats
+{
+	using Queue::Queue;
+
+	template<class... Args>
+	unsigned give( Args&&... args )
+	{
+		unsigned result = Queue::give(std::forward<Args>(args)...);
+		if (result == E_SUCCESS) in(); else overflows++;
+		return result;
+	}
+
+	template<class... Args>
+	unsigned send( Args&&... args )
+	{
+		unsigned result = Queue::give(args...);
+		if (result != E_SUCCESS)
+		{
+			blocks++;
+			result = Queue::send(std::forward<Args>(args)...);
+		}
+		if (result == E_SUCCESS) in();
+		return result;
+	}
+
+	template<class... Args>
+	unsigned take( Args&&... args )
+	{
+		unsigned result = Queue::take(std::forward<Args>(args)...);
+		if (result == E_SUCCESS) out(); else empties++;
+		return result;
+	}
+
+	template<class... Args>
+	unsigned wait( Args&&... args )
+	{
+		unsigned result = Queue::take(args...);
+		if (result != E_SUCCESS)
+		{
+			empties++;
+			result = Queue::wait(std::forward<Args>(args)...);
+		}
+		if (result == E_SUCCESS) out();
+		return result;
+	}
+};
+
+// the memory pool works the other way round: the blocks taken from the pool are its fill level,
+// a task that finds the pool exhausted is counted as blocked or failed
+template<class Pool>
+struct MeasuredPool : public Pool, public QueueStats
+{
+	using Pool::Pool;
+
+	template<class T>
+	unsigned take( T **ptr )
+	{
+		unsigned result = Pool::take(ptr);
+		if (result == E_SUCCESS) in(); else overflows++;
+		return result;
+	}
+
+	template<class T>
+	unsigned wait( T **ptr )
+	{
+		unsigned result = Pool::take(ptr);
+		if (result != E_SUCCESS)
+		{
+			blocks++;
+			result = Pool::wait(ptr);
+		}
+		if (result == E_SUCCESS) in();
+		return result;
+	}
+
+	template<class T>
+	void give( const T *ptr )
+	{
+		Pool::give(ptr);
+		out();
+	}
+};
+
+auto led = Led();
+auto grn = GreenLed();
+auto evq = Measured<EventQueueT<1>>();
+auto msg = Measured<MessageQueueTT<1, unsigned>>();
+auto box = Measured<MailBoxQueueTT<1, unsigned>>();
+auto raw = Measured<RawBufferTT<1, unsigned>>();
+auto job = Measured<JobQueueT<1>>();
+auto mem = MeasuredPool<MemoryPoolTT<1, unsigned>>();
+
+void consumer()
+{
+	unsigned x, *p;
+
+	for (;;)
+	{
+		evq.wait(x);
+		led = x;
+		msg.take(&x);
+		box.take(&x);
+		raw.take(&x);
+		job.take();
+		if (mem.take(&p) == E_SUCCESS)
+			mem.give(p);
+	}
+}
+
+void producer()
+{
+	unsigned x = 1;
+
+	for (;;)
+	{
+		thisTask::delay(SEC);
+		msg.give(&x);
+		box.give(&x);
+		raw.give(&x);
+		job.give([]{ grn = evq.overflows + msg.overflows + box.overflows + raw.overflows + job.overflows > 0; });
+		evq.give(x);
+		evq.give(x); // the second event doesn't fit
+		x = (x << 1) | (x >> 3);
+	}
+}
+
+auto cons = Task(consumer);
+auto prod = Task(producer);
+
+int main()
+{
+	cons.start();
+	prod.start();
+
+	thisTask::stop();
+}
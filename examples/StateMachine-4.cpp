@@ -0,0 +1,87 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <array>
+
+using namespace device;
+using namespace intros;
+
+enum State : unsigned
+{
+	StateOff,
+	StateOn,
+	States,
+};
+
+enum Event : unsigned
+{
+	EventInit,
+	EventSwitch,
+	EventTick,
+	Events,
+};
+
+struct Transition
+{
+	State state;
+	Event event;
+	State next;
+	void (*action)();
+};
+
+// the list of transitions is resolved at compile time into the dense table
+// indexed by the state and the event; the table is placed in flash
+template<size_t size_>
+constexpr auto makeTable( const Transition (&list)[size_] )
+{
+	std::array<std::array<Transition, Events>, States> table {};
+	for (unsigned s = 0; s < States; s++)
+		for (unsigned e = 0; e < Events; e++)
+			table[s][e] = { State(s), Event(e), State(s), nullptr };
+	for (auto &t: list)
+		table[t.state][t.event] = t;
+	return table;
+}
+
+auto led = Led();
+
+constexpr Transition list[] =
+{
+	{ StateOff, EventInit,   StateOff, []{ led = 0; } },
+	{ StateOff, EventSwitch, StateOn,  nullptr },
+	{ StateOn,  EventSwitch, StateOff, nullptr },
+	{ StateOn,  EventTick,   StateOn,  []{ led.tick(); } },
+};
+
+constexpr auto table = makeTable(list);
+static_assert(table[StateOff][EventSwitch].next == StateOn);
+
+struct Machine
+{
+	constexpr Machine( State init ): state_{init} {}
+
+	void dispatch( Event event )
+	{
+		auto &t = table[state_][event];
+		if (t.action != nullptr)
+			t.action();
+		state_ = t.next;
+	}
+
+	private:
+	State state_;
+};
+
+auto blinker    = Machine(StateOff);
+auto evq        = EventQueueT<4>();
+auto dispatcher = Task::Start([]{ unsigned e; evq.wait(e); blinker.dispatch(Event(e)); });
+
+int main()
+{
+	evq.give(EventInit);
+	evq.give(EventSwitch);
+	for (;;)
+	{
+		thisTask::delay(SEC);
+		evq.give(EventTick);
+	}
+}
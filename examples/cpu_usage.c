@@ -0,0 +1,117 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// the timer interrupt handler samples the current task, the share of the samples is the cpu share of the task
+// the idle task only yields, so it is current when no other task is ready: its share is the idle time
+// the idle task stamps every round of the scheduler with the DWT cycle counter,
+// the time from the stamp to the sample bounds the run without yielding of the sampled task
+// (it includes the tasks that ran before it in the same round)
+// the sampling frequency is prime, so it doesn't beat with the system tick
+
+#define CPU_SAMPLE_FREQ  9973
+#define CPU_TASKS        4
+
+typedef struct
+{
+	tsk_t   *tsk;
+	unsigned samples;
+	unsigned share;      // in permille, for the last second
+	uint32_t longest;    // cycles of the longest run without yielding
+} cpu_t;
+
+cpu_t    cpu[CPU_TASKS];
+unsigned cpu_total;
+unsigned cpu_idle;       // idle share in permille, for the last second
+volatile uint32_t cpu_round;
+
+OS_TSK_DEF(idle)
+{
+	cpu_round = DWT->CYCCNT;
+	tsk_yield();
+}
+
+void TIM3_IRQHandler(void)
+{
+	tsk_t   *cur = tsk_this();
+	uint32_t run = DWT->CYCCNT - cpu_round;
+
+	TIM3->SR = ~TIM_SR_UIF;
+
+	cpu_total++;
+	for (cpu_t *c = cpu; c < cpu + CPU_TASKS && c->tsk; c++)
+	{
+		if (c->tsk != cur)
+			continue;
+		c->samples++;
+		if (cur != idle && run > c->longest)
+			c->longest = run;
+		break;
+	}
+}
+
+void cpu_watch(tsk_t *tsk)
+{
+	for (cpu_t *c = cpu; c < cpu + CPU_TASKS; c++)
+	{
+		if (c->tsk == NULL)
+		{
+			c->tsk = tsk;
+			break;
+		}
+	}
+}
+
+void cpu_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	cpu_watch(idle);
+	tsk_start(idle);
+
+	RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+	TIM3->PSC  = 0;
+	TIM3->ARR  = CPU_FREQUENCY / 2 / CPU_SAMPLE_FREQ - 1;
+	TIM3->DIER = TIM_DIER_UIE;
+	TIM3->CR1  = TIM_CR1_CEN;
+	NVIC_EnableIRQ(TIM3_IRQn);
+}
+
+// the shares are computed once a second, the counters start again
+OS_TSK_DEF(report)
+{
+	tsk_delay(SEC);
+
+	NVIC_DisableIRQ(TIM3_IRQn);
+	for (cpu_t *c = cpu; c < cpu + CPU_TASKS && c->tsk; c++)
+	{
+		c->share = cpu_total ? c->samples * 1000U / cpu_total : 0;
+		c->samples = 0;
+	}
+	cpu_total = 0;
+	NVIC_EnableIRQ(TIM3_IRQn);
+
+	cpu_idle = cpu[0].share;
+	LEDs = (1 << ((1000 - cpu_idle) * 4 / 1000)) - 1; // load bar
+}
+
+OS_TSK_DEF(worker)
+{
+	cnt_t start = sys_time();
+
+	while (sys_time() - start < MSEC*30); // busy for 30 ms without yielding
+	tsk_delay(MSEC*70);
+}
+
+int main()
+{
+	LED_Init();
+
+	cpu_init();
+	cpu_watch(worker);
+	cpu_watch(report);
+	tsk_start(worker);
+	tsk_start(report);
+	tsk_sleep();
+}
@@ -0,0 +1,72 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <stdio.h>
+
+// the log call only stores the format string and raw arguments,
+// the messages are formatted and printed by the drain task when the others are blocked
+// tasks don't preempt each other, so the ring buffer has always one producer at a time
+
+#define LOG_SIZE 32
+
+#define LOG(...) LOG_(__VA_ARGS__, 0, 0, 0)
+#define LOG_(format, a, b, c, ...) log_put(format, (unsigned)(a), (unsigned)(b), (unsigned)(c))
+
+typedef struct
+{
+	const char *format;
+	unsigned    arg[3];
+} log_t;
+
+log_t    log_ring[LOG_SIZE];
+unsigned log_head;
+unsigned log_tail;
+unsigned log_lost;
+
+void log_put(const char *format, unsigned a, unsigned b, unsigned c)
+{
+	unsigned h = log_head;
+
+	if (h - log_tail >= LOG_SIZE)
+	{
+		log_lost++;
+		return;
+	}
+
+	log_t *rec = &log_ring[h % LOG_SIZE];
+	rec->format = format;
+	rec->arg[0] = a;
+	rec->arg[1] = b;
+	rec->arg[2] = c;
+	log_head = h + 1;
+}
+
+OS_TSK_DEF(drain)
+{
+	if (log_tail == log_head)
+	{
+		tsk_yield();
+		return;
+	}
+
+	log_t *rec = &log_ring[log_tail % LOG_SIZE];
+	printf(rec->format, rec->arg[0], rec->arg[1], rec->arg[2]);
+	log_tail++;
+}
+
+OS_TSK_DEF(prod)
+{
+	static unsigned x = 1;
+
+	tsk_delay(SEC);
+	LED_Tick();
+	LOG("tick %u at %u (lost %u)\n", x++, sys_time(), log_lost);
+}
+
+int main()
+{
+	LED_Init();
+
+	tsk_start(drain);
+	tsk_start(prod);
+	tsk_sleep();
+}
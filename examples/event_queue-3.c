@@ -0,0 +1,59 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// the whole burst of events is given at once
+// and taken by the consumer in one wakeup
+
+OS_EVQ(evq, 4);
+
+unsigned give_many(evq_t *evq, const unsigned *data, unsigned num)
+{
+	unsigned cnt = 0;
+	while (cnt < num && evq_give(evq, data[cnt]) == E_SUCCESS) cnt++;
+	return cnt;
+}
+
+unsigned wait_many(evq_t *evq, unsigned *data, unsigned max)
+{
+	unsigned cnt = 0;
+	if (max > 0 && evq_wait(evq, &data[cnt]) == E_SUCCESS)
+		for (cnt++; cnt < max && evq_take(evq, &data[cnt]) == E_SUCCESS; cnt++);
+	return cnt;
+}
+
+void consumer()
+{
+	unsigned events[4];
+
+	for (;;)
+	{
+		unsigned cnt = wait_many(evq, events, 4);
+		for (unsigned i = 0; i < cnt; i++)
+			LED[i] = events[i];
+	}
+}
+
+void producer()
+{
+	static const unsigned burst[2][4] = { { 1, 0, 1, 0 }, { 0, 1, 0, 1 } };
+	unsigned x = 0;
+
+	for (;;)
+	{
+		tsk_delay(SEC);
+		give_many(evq, burst[x], 4);
+		x = x ^ 1;
+	}
+}
+
+OS_WRK(cons, consumer, 256);
+OS_WRK(prod, producer, 256);
+
+int main()
+{
+	LED_Init();
+
+	tsk_start(cons);
+	tsk_start(prod);
+	tsk_stop();
+}
@@ -0,0 +1,62 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <stdatomic.h>
+
+// single-producer / single-consumer ring buffer
+// the interrupt handler never enters a critical section:
+// the kernel is called only when the ring buffer was empty,
+// with the asynchronous version of the function (OS_ATOMICS)
+
+#define RING_SIZE 16
+
+unsigned    ring[RING_SIZE];
+atomic_uint head; // written by the interrupt handler only
+atomic_uint tail; // written by the consumer task only
+
+OS_SEM(sem, 0, semBinary);
+
+void EXTI0_IRQHandler(void)
+{
+	static unsigned x = 1;
+
+	unsigned h = atomic_load_explicit(&head, memory_order_relaxed);
+	unsigned t = atomic_load_explicit(&tail, memory_order_acquire);
+
+	if (h - t < RING_SIZE)
+	{
+		ring[h % RING_SIZE] = x;
+		atomic_store_explicit(&head, h + 1, memory_order_release);
+		if (h == t)
+			sem_giveAsync(sem);
+		x = (x << 1) | (x >> 3);
+	}
+}
+
+OS_TSK_DEF(cons)
+{
+	unsigned t = atomic_load_explicit(&tail, memory_order_relaxed);
+	unsigned h = atomic_load_explicit(&head, memory_order_acquire);
+
+	if (h == t)
+	{
+		sem_wait(sem);
+		return;
+	}
+
+	LEDs = ring[t % RING_SIZE] & 0x0F;
+	atomic_store_explicit(&tail, t + 1, memory_order_release);
+}
+
+OS_TMR_START(tmr, SEC, SEC)
+{
+	NVIC_SetPendingIRQ(EXTI0_IRQn); // the interrupt is triggered by software
+}
+
+int main()
+{
+	LED_Init();
+	NVIC_EnableIRQ(EXTI0_IRQn);
+
+	tsk_start(cons);
+	tsk_sleep();
+}
@@ -0,0 +1,92 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// the periodic loop records the lateness of every release (in ticks):
+// max, mean and log2 histogram, and counts the missed periods
+
+typedef struct
+{
+	cnt_t    period;
+	cnt_t    release;
+	void   (*overrun)(void);
+	unsigned count;
+	unsigned missed;
+	cnt_t    max;
+	unsigned long sum;
+	unsigned hist[8];
+} period_t;
+
+bool passed(cnt_t time)
+{
+	return (cnt_t)(sys_time() - time - 1) < (cnt_t)((cnt_t)0 - 1) / 2;
+}
+
+void period_start(period_t *per, cnt_t period, void (*overrun)(void))
+{
+	per->period  = period;
+	per->release = sys_time();
+	per->overrun = overrun;
+}
+
+void period_wait(period_t *per)
+{
+	cnt_t late;
+	unsigned i;
+
+	per->release += per->period;
+	while (passed(per->release)) // the period has been missed
+	{
+		per->release += per->period;
+		per->missed++;
+		if (per->overrun)
+			per->overrun();
+	}
+
+	tsk_sleepUntil(per->release);
+
+	late = sys_time() - per->release;
+	per->count++;
+	per->sum += late;
+	if (late > per->max) per->max = late;
+	for (i = 0; i < 7 && (late >> i) > 0; i++);
+	per->hist[i]++;
+}
+
+cnt_t period_mean(period_t *per)
+{
+	return per->count ? (cnt_t)(per->sum / per->count) : 0;
+}
+
+void overrun()
+{
+	GRN = 1;
+}
+
+OS_TSK_DEF(blinker)
+{
+	static period_t per;
+
+	period_start(&per, SEC/2, overrun);
+	for (;;)
+	{
+		period_wait(&per);
+		LED_Tick();
+	}
+}
+
+OS_TSK_DEF(hog)
+{
+	cnt_t start = sys_time();
+	while (sys_time() - start < SEC); // doesn't yield for a second
+	tsk_delay(SEC*4);
+}
+
+int main()
+{
+	LED_Init();
+	GRN_Init();
+
+	tsk_start(blinker);
+	tsk_start(hog);
+	tsk_sleep();
+}
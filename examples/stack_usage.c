@@ -0,0 +1,63 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include <string.h>
+
+// stacks are painted before the tasks are started
+// the part of the stack that is still painted has never been used
+
+#define STK_PAINT 0xA5
+
+#ifndef OS_GUARD_SIZE
+#define OS_GUARD_SIZE 0
+#endif
+
+void stk_paint(void *stk, size_t size)
+{
+	memset(stk, STK_PAINT, size);
+}
+
+size_t stk_used(const void *stk, size_t size)
+{
+	const unsigned char *ptr = stk;
+	size_t i = 2 * OS_GUARD_SIZE; // the guard region may be inaccessible (MPU)
+
+	while (i < size && ptr[i] == STK_PAINT) i++;
+	return size - i;
+}
+
+sem_t sem;
+tsk_t cons; stk_t cons_stk[STK_SIZE(256)];
+tsk_t prod; stk_t prod_stk[STK_SIZE(512)];
+
+void consumer()
+{
+	sem_wait(&sem);
+	LED[0]++;
+}
+
+void producer()
+{
+	tsk_delay(SEC);
+	sem_give(&sem);
+}
+
+int main()
+{
+	LED_Init();
+	GRN_Init();
+
+	stk_paint(cons_stk, sizeof(cons_stk));
+	stk_paint(prod_stk, sizeof(prod_stk));
+
+	sem_init(&sem, 0, semBinary);
+	tsk_init(&cons, consumer, cons_stk, sizeof(cons_stk));
+	tsk_init(&prod, producer, prod_stk, sizeof(prod_stk));
+
+	for (;;)
+	{
+		tsk_delay(SEC);
+		// the high-water mark of any stack above 3/4 of its size
+		GRN = stk_used(cons_stk, sizeof(cons_stk)) > sizeof(cons_stk) * 3 / 4
+		   || stk_used(prod_stk, sizeof(prod_stk)) > sizeof(prod_stk) * 3 / 4;
+	}
+}
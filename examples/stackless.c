@@ -0,0 +1,91 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// run-to-completion activities don't need their own stacks, all of them are executed by one worker on its stack
+// every activity is a state procedure and the object it waits for;
+// the worker runs the procedure only when it can take the object, so the activity blocks between the procedures only
+// the procedure is executed again and again until it switches the activity to the next state with act_flip (as tsk_flip does)
+// an activity costs sizeof(act_t) bytes of ram instead of a task with its own stack
+
+typedef struct act act_t;
+
+struct act
+{
+	void     (*state)(act_t *);
+	unsigned (*take)(act_t *);
+	void      *obj;
+	unsigned   data;  // the event taken from the event queue, or the user data
+};
+
+unsigned take_sem(act_t *act) { return sem_take(act->obj); }
+unsigned take_evq(act_t *act) { return evq_take(act->obj, &act->data); }
+
+void act_flip(act_t *act, void (*state)(act_t *), unsigned (*take)(act_t *), void *obj)
+{
+	act->state = state;
+	act->take  = take;
+	act->obj   = obj;
+}
+
+OS_SEM(wake, 0, semBinary); // given by every source after it has given the object
+
+void act_loop(act_t *act, unsigned count)
+{
+	bool busy = false;
+
+	for (act_t *a = act; a < act + count; a++)
+	{
+		if (a->take(a) == E_SUCCESS)
+		{
+			a->state(a);
+			busy = true;
+		}
+	}
+
+	if (!busy)
+		sem_wait(wake);
+}
+
+// activities
+
+OS_SEM(sem0, 0, semBinary);
+OS_SEM(sem1, 0, semBinary);
+OS_SEM(sem2, 0, semBinary);
+OS_SEM(sem3, 0, semBinary);
+OS_EVQ(evq, 1);
+
+void blink(act_t *act) { LED[act->data]++; }
+
+void off(act_t *act);
+void on (act_t *act) { if (act->data == 0) { GRN = 0; act_flip(act, off, take_evq, evq); } }
+void off(act_t *act) { if (act->data != 0) { GRN = 1; act_flip(act, on,  take_evq, evq); } }
+
+act_t act[] =
+{
+	{ blink, take_sem, sem0, 0 },
+	{ blink, take_sem, sem1, 1 },
+	{ blink, take_sem, sem2, 2 },
+	{ blink, take_sem, sem3, 3 },
+	{ off,   take_evq, evq,  0 },
+};
+
+OS_TSK_START(worker)
+{
+	act_loop(act, sizeof(act) / sizeof(*act));
+}
+
+// sources
+
+OS_TMR_START(t0, SEC/8*0, SEC/2) { sem_give(sem0); sem_give(wake); }
+OS_TMR_START(t1, SEC/8*1, SEC/2) { sem_give(sem1); sem_give(wake); }
+OS_TMR_START(t2, SEC/8*2, SEC/2) { sem_give(sem2); sem_give(wake); }
+OS_TMR_START(t3, SEC/8*3, SEC/2) { sem_give(sem3); sem_give(wake); }
+OS_TMR_START(t4, SEC, SEC)       { static unsigned x = 0; evq_give(evq, x ^= 1); sem_give(wake); }
+
+int main()
+{
+	LED_Init();
+	GRN_Init();
+
+	tsk_stop();
+}
@@ -0,0 +1,88 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// the heartbeat task gets the cpu once in every round of the scheduler
+// if it hasn't got the cpu for longer than the budget, the current task hasn't yielded
+// the check is done in the timer interrupt handler, independent of the scheduler
+
+#define WDG_BUDGET  (SEC/10) // the longest allowed run without yielding
+#define WDG_FREQ     100     // frequency of the check
+
+volatile cnt_t wdg_seen;
+volatile bool  wdg_reported; // the current stall has already been reported
+tsk_t   *wdg_task;           // the offending task
+uint32_t wdg_pc;             // where it was running
+unsigned wdg_count;
+
+void wdg_hook(void)
+{
+	GRN = 1;
+}
+
+OS_TSK_DEF(heartbeat)
+{
+	wdg_seen = sys_time();
+	wdg_reported = false;
+	tsk_yield();
+}
+
+__attribute__((used)) // referenced only from the assembly code
+void wdg_check(const uint32_t *frame)
+{
+	TIM2->SR = ~TIM_SR_UIF;
+
+	if (sys_time() - wdg_seen > WDG_BUDGET && !wdg_reported)
+	{
+		wdg_reported = true;    // report every stall once
+		wdg_task  = tsk_this();
+		wdg_pc    = frame[6];   // the return address from the exception stack frame
+		wdg_count++;
+		wdg_hook();
+	}
+}
+
+__attribute__((naked))
+void TIM2_IRQHandler(void)
+{
+	__asm volatile
+	(
+		"tst   lr, #4    \n"
+		"ite   eq        \n"
+		"mrseq r0, msp   \n"
+		"mrsne r0, psp   \n"
+		"b     wdg_check \n"
+	);
+}
+
+void wdg_init(void)
+{
+	wdg_seen = sys_time();
+	tsk_start(heartbeat);
+
+	RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+	TIM2->PSC  = CPU_FREQUENCY / 2 / 10000 - 1;
+	TIM2->ARR  = 10000 / WDG_FREQ - 1;
+	TIM2->DIER = TIM_DIER_UIE;
+	TIM2->CR1  = TIM_CR1_CEN;
+	NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+OS_TSK_DEF(hog)
+{
+	cnt_t start;
+
+	tsk_delay(SEC*4);
+	LED_Tick();
+	start = sys_time();
+	while (sys_time() - start < SEC); // doesn't yield for a second
+}
+
+int main()
+{
+	LED_Init();
+	GRN_Init();
+
+	wdg_init();
+	tsk_start(hog);
+	tsk_sleep();
+}
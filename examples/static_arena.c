@@ -0,0 +1,116 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// the objects are created at startup one after another in a static arena, they are never destroyed:
+// there is no free list and no heap manager, the allocation only moves the top of the arena
+// the size of the arena is the sum of the sizes of the objects known at compile time,
+// the compiler checks it against the limit and the linker checks .bss against the ram region
+
+#define ARENA_LIMIT      4096
+#define ARENA_ALIGN(s)  (STK_SIZE(s) * sizeof(stk_t))
+
+#define CONS_STACK        256
+#define PROD_STACK        256
+#define DISP_STACK        256
+#define DISP_QUEUE          1
+
+#define ARENA_SIZE ( \
+	ARENA_ALIGN(sizeof(sem_t)) + \
+	ARENA_ALIGN(sizeof(sig_t)) + \
+	ARENA_ALIGN(sizeof(hsm_t)) + ARENA_ALIGN(sizeof(unsigned[DISP_QUEUE])) + \
+	ARENA_ALIGN(sizeof(tsk_t)) + ARENA_ALIGN(CONS_STACK) + \
+	ARENA_ALIGN(sizeof(tsk_t)) + ARENA_ALIGN(PROD_STACK) + \
+	ARENA_ALIGN(sizeof(tsk_t)) + ARENA_ALIGN(DISP_STACK) )
+
+_Static_assert(ARENA_SIZE <= ARENA_LIMIT, "the arena exceeds its limit");
+
+stk_t  arena[ARENA_SIZE / sizeof(stk_t)] __attribute__((section(".bss.arena")));
+size_t arena_top;
+
+void *arena_alloc(size_t size)
+{
+	void *ptr = (char *)arena + arena_top;
+
+	size = ARENA_ALIGN(size);
+	assert(arena_top + size <= sizeof(arena)); // the object is missing from ARENA_SIZE
+	arena_top += size;
+	return ptr;
+}
+
+sem_t *sem_arena(unsigned init, unsigned limit)
+{
+	sem_t *sem = arena_alloc(sizeof(sem_t));
+	sem_init(sem, init, limit);
+	return sem;
+}
+
+sig_t *sig_arena(unsigned mask)
+{
+	sig_t *sig = arena_alloc(sizeof(sig_t));
+	sig_init(sig, mask);
+	return sig;
+}
+
+hsm_t *hsm_arena(unsigned limit)
+{
+	hsm_t *hsm = arena_alloc(sizeof(hsm_t));
+	hsm_init(hsm, arena_alloc(sizeof(unsigned) * limit), sizeof(unsigned) * limit);
+	return hsm;
+}
+
+tsk_t *wrk_arena(fun_t *state, size_t size)
+{
+	tsk_t *tsk = arena_alloc(sizeof(tsk_t));
+	wrk_init(tsk, state, arena_alloc(size), ARENA_ALIGN(size));
+	return tsk;
+}
+
+sem_t *sem;
+sig_t *sig;
+hsm_t *blinker;
+
+hsm_state_t StateOn;
+
+void StateOnHandler(hsm_t *hsm, unsigned event)
+{
+	(void) hsm;
+
+	if (event == hsmUser)
+		LED_Tick();
+}
+
+hsm_action_t tab[] =
+{
+	HSM_ACTION_INIT(&StateOn, hsmUser, NULL, StateOnHandler),
+};
+
+void consumer()
+{
+	sem_wait(sem);
+	hsm_send(blinker, hsmUser);
+	sig_give(sig, 0);
+}
+
+void producer()
+{
+	tsk_delay(SEC);
+	sem_give(sem);
+	sig_wait(sig, sigAll, NULL); // wait for the consumer
+}
+
+int main()
+{
+	LED_Init();
+
+	sem     = sem_arena(0, semBinary);
+	sig     = sig_arena(0);
+	blinker = hsm_arena(DISP_QUEUE);
+
+	hsm_initState(&StateOn, NULL);
+	hsm_link(&tab[0]);
+	hsm_start(blinker, wrk_arena(NULL, DISP_STACK), &StateOn);
+
+	tsk_start(wrk_arena(consumer, CONS_STACK));
+	tsk_start(wrk_arena(producer, PROD_STACK));
+	tsk_sleep();
+}
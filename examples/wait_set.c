@@ -0,0 +1,90 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// one task serves several objects
+// every source gives the counting semaphore after posting its data,
+// so the number of tokens is equal to the number of pending items;
+// the one-shot timer gives a token without an item and sets the flag
+
+enum { WaitCmd, WaitEvt, WaitTick, WaitTimeout };
+
+OS_MSG(cmd, 4, sizeof(unsigned));
+OS_EVQ(evq, 4);
+OS_SEM(tick, 0, semCounting);
+OS_SEM(any,  0, semCounting);
+
+volatile bool expired = false;
+
+OS_TMR_DEF(timeout)
+{
+	expired = true;
+	sem_give(any);
+}
+
+unsigned wait_any(unsigned *data, cnt_t delay)
+{
+	tmr_startFor(timeout, delay);
+	sem_wait(any);
+	tmr_stop(timeout);
+	if (expired)
+	{
+		expired = false;
+		return WaitTimeout;
+	}
+	if (msg_take(cmd, data, sizeof(*data), NULL) == E_SUCCESS)
+		return WaitCmd;
+	if (evq_take(evq, data) == E_SUCCESS)
+		return WaitEvt;
+	sem_take(tick);
+	return WaitTick;
+}
+
+OS_TSK_DEF(gateway)
+{
+	unsigned x;
+
+	switch (wait_any(&x, 2*SEC))
+	{
+	case WaitCmd:  LEDs = x & 0x0F; break;
+	case WaitEvt:  GRN = x;         break;
+	case WaitTick: LED_Tick();      break;
+	default:       LEDs = 0;        break;
+	}
+}
+
+OS_TSK_DEF(prod)
+{
+	unsigned x = 1;
+
+	for (;;)
+	{
+		tsk_delay(SEC*4);
+		if (msg_give(cmd, &x, sizeof(x)) == E_SUCCESS)
+			sem_give(any);
+		x = (x << 1) | (x >> 3);
+	}
+}
+
+OS_TMR_START(tmr, SEC*5, SEC*5) // slower than the timeout, so the timeout happens between the events
+{
+	if (sem_give(tick) == E_SUCCESS)
+		sem_give(any);
+}
+
+OS_TMR_START(irq, SEC/2, SEC*3) // stands for the interrupt source
+{
+	static unsigned x = 0;
+
+	if (evq_give(evq, x ^= 1) == E_SUCCESS)
+		sem_give(any);
+}
+
+int main()
+{
+	LED_Init();
+	GRN_Init();
+
+	tsk_start(gateway);
+	tsk_start(prod);
+	tsk_sleep();
+}
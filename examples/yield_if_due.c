@@ -0,0 +1,64 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// long computation yields only when its time slice is exhausted
+// the check is done every byte, so it must not call the kernel: sys_time() is a function call
+// that may enter a critical section, while reading the DWT cycle counter is a single load;
+// the cycle count of the last yield is cached by the caller
+
+#define SLICE  (CPU_FREQUENCY / 1000) // 1 ms in cpu cycles
+
+static inline
+void yield_if_due(uint32_t *mark, uint32_t budget)
+{
+	if (DWT->CYCCNT - *mark >= budget)
+	{
+		tsk_yield();
+		*mark = DWT->CYCCNT;
+	}
+}
+
+uint32_t crc32(const uint8_t *data, size_t size)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	uint32_t mark = DWT->CYCCNT;
+
+	while (size--)
+	{
+		crc ^= *data++;
+		for (int i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+		yield_if_due(&mark, SLICE);
+	}
+
+	return ~crc;
+}
+
+OS_TSK_DEF(calc)
+{
+	static uint32_t last = 0;
+	uint32_t crc = crc32((const uint8_t *)FLASH_BASE, 0x10000);
+
+	if (last != 0 && crc != last)
+		GRN = 1; // flash content has changed
+	last = crc;
+}
+
+OS_TSK_DEF(blinker)
+{
+	tsk_sleepNext(SEC/10);
+	LED_Tick();
+}
+
+int main()
+{
+	LED_Init();
+	GRN_Init();
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	tsk_start(calc);
+	tsk_start(blinker);
+	tsk_sleep();
+}
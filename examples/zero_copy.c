@@ -0,0 +1,52 @@
+#include <stm32f4_discovery.h>
+#include <os.h>
+
+// frames are written in place once and read in place once,
+// only the pointers are passed through the list
+
+typedef struct
+{
+	unsigned leds;
+	unsigned char data[252];
+} frame_t;
+
+OS_MEM(mem, 2, sizeof(frame_t));
+OS_LST(lst);
+
+frame_t *frm_reserve() { void *p; mem_wait(mem, &p); return p; }
+void     frm_commit (frame_t *frm) { lst_give(lst, frm); }
+frame_t *frm_peek   () { void *p; lst_wait(lst, &p); return p; }
+void     frm_release(frame_t *frm) { mem_give(mem, frm); }
+
+OS_TSK_DEF(cons)
+{
+	for (;;)
+	{
+		frame_t *frm = frm_peek();
+		LEDs = frm->leds & 0x0F;
+		frm_release(frm);
+	}
+}
+
+OS_TSK_DEF(prod)
+{
+	unsigned x = 1;
+
+	for (;;)
+	{
+		tsk_delay(SEC);
+		frame_t *frm = frm_reserve();
+		frm->leds = x;
+		frm_commit(frm);
+		x = (x << 1) | (x >> 3);
+	}
+}
+
+int main()
+{
+	LED_Init();
+
+	tsk_start(cons);
+	tsk_start(prod);
+	tsk_sleep();
+}
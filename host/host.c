@@ -0,0 +1,51 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stm32f4_discovery.h>
+#include <os.h>
+#include "host.h"
+
+#define SYS_WRITE0      0x04
+#define SYS_EXIT        0x18
+#define ADP_EXIT        0x20026
+
+static
+int semihost( int op, const void *arg )
+{
+	register int         r0 __asm("r0") = op;
+	register const void *r1 __asm("r1") = arg;
+	__asm volatile ("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+	return r0;
+}
+
+void host_print( const char *format, ... )
+{
+	char buf[128];
+	va_list args;
+
+	va_start(args, format);
+	vsnprintf(buf, sizeof(buf), format, args);
+	va_end(args);
+
+	semihost(SYS_WRITE0, buf);
+}
+
+void host_exit( int status )
+{
+	(void) status;
+
+	for (;;)
+		semihost(SYS_EXIT, (const void *)ADP_EXIT);
+}
+
+bool host_cycles( void )
+{
+	uint32_t cycles;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	cycles = DWT->CYCCNT;
+	tsk_yield();
+	return DWT->CYCCNT != cycles;
+}
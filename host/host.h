@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdbool.h>
+
+// services shared by the bench and trace targets
+// the output and the exit are done by semihosting, so the program should be run with __QEMU or __MONITOR option
+
+void  host_print ( const char *format, ... );
+void  host_exit  ( int status );
+
+// starts the DWT cycle counter and checks if it is running (it is not emulated by qemu)
+bool  host_cycles( void );
@@ -0,0 +1,68 @@
+#include "host.h"
+#include "trace.h"
+
+// producer and consumer of the messages, paced by the periodic timer;
+// the trace of the first quarter of a second is dumped by semihosting and converted on the host:
+// trace2json < output.txt > trace.json
+
+#define TRACE_TIME (SEC/4)
+
+OS_SEM(trace_sem, 0);
+OS_MSG(trace_msg, 4, sizeof(unsigned));
+OS_EVQ(trace_evq, 4);
+
+OS_TMR_DEF(trace_tmr)
+{
+	TRC_TIMER(trace_tmr);
+	TRC_GIVE(trace_sem, sem_give(trace_sem));
+}
+
+OS_TSK_DEF(trace_prod)
+{
+	static unsigned x = 0;
+
+	TRC_WAIT(trace_sem, sem_wait(trace_sem));
+	TRC_GIVE(trace_msg, msg_send(trace_msg, &x, sizeof(x)));
+	x++;
+}
+
+OS_TSK_DEF(trace_cons)
+{
+	unsigned x;
+
+	TRC_WAIT(trace_msg, msg_wait(trace_msg, &x, sizeof(x), NULL));
+	if (x % 4 == 0)
+		TRC_GIVE(trace_evq, evq_give(trace_evq, x));
+}
+
+OS_TSK_DEF(trace_mon)
+{
+	unsigned x;
+
+	while (TRC_TAKE(trace_evq, evq_take(trace_evq, &x)) == E_SUCCESS);
+	tsk_delay(SEC/20);
+}
+
+int main()
+{
+	trc_init();
+
+	trc_name(trace_prod, "prod");
+	trc_name(trace_cons, "cons");
+	trc_name(trace_mon,  "mon");
+	trc_name(trace_sem,  "sem");
+	trc_name(trace_msg,  "msg");
+	trc_name(trace_evq,  "evq");
+	trc_name(trace_tmr,  "tmr");
+
+	tsk_start(trace_prod);
+	tsk_start(trace_cons);
+	tsk_start(trace_mon);
+	tmr_startPeriodic(trace_tmr, SEC/100);
+
+	tsk_delay(TRACE_TIME);
+	tmr_stop(trace_tmr);
+
+	trc_dump();
+	host_exit(0);
+}
@@ -0,0 +1,103 @@
+#include <stm32f4_discovery.h>
+#include "host.h"
+#include "trace.h"
+
+#if TRC_SIZE
+
+#if TRC_SIZE & (TRC_SIZE - 1)
+#error TRC_SIZE must be a power of two
+#endif
+
+trc_buf_t trc_buf = { TRC_MAGIC, CPU_FREQUENCY, TRC_SIZE, 0, { { 0, 0, 0, 0 } } };
+
+static struct { const void *ptr; const char *name; } trc_names[TRC_NAMES];
+static unsigned trc_count;
+static tsk_t   *trc_last;
+static uint8_t  trc_task;
+static bool     dwt;
+
+void trc_init( void )
+{
+	dwt = host_cycles();
+}
+
+void trc_name( const void *ptr, const char *name )
+{
+	if (trc_count < TRC_NAMES)
+	{
+		trc_names[trc_count].ptr  = ptr;
+		trc_names[trc_count].name = name;
+		trc_count++;
+	}
+}
+
+static
+unsigned trc_id( const void *ptr )
+{
+	for (unsigned i = 0; i < trc_count; i++)
+		if (trc_names[i].ptr == ptr)
+			return i + 1;
+	return 0;
+}
+
+static
+uint32_t trc_time( void )
+{
+	if (dwt)
+		return DWT->CYCCNT;
+	return (uint32_t)sys_time() * (CPU_FREQUENCY / OS_FREQUENCY);
+}
+
+static
+void trc_write( unsigned event, unsigned obj )
+{
+	trc_rec_t *rec = &trc_buf.rec[trc_buf.head++ % TRC_SIZE];
+
+	rec->time  = trc_time();
+	rec->event = (uint8_t)event;
+	rec->task  = trc_task;
+	rec->obj   = (uint16_t)obj;
+}
+
+void trc_put( unsigned event, const void *obj )
+{
+	tsk_t *cur = tsk_this();
+
+	if (cur != trc_last) // the task has been switched since the previous record
+	{
+		trc_last = cur;
+		trc_task = (uint8_t)trc_id(cur);
+		trc_write(TrcSwitch, trc_task);
+	}
+
+	trc_write(event, trc_id(obj));
+}
+
+unsigned trc_done( unsigned event, const void *obj, unsigned result )
+{
+	trc_put(result == E_SUCCESS ? event : TrcTimeout, obj);
+	return result;
+}
+
+// the text dump is read by the host converter (trace2json)
+
+void trc_dump( void )
+{
+	uint32_t head  = trc_buf.head;
+	uint32_t first = head > TRC_SIZE ? head - TRC_SIZE : 0;
+
+	host_print("trace,%lu,%lu,%lu\n", (unsigned long)trc_buf.freq, (unsigned long)trc_buf.size, (unsigned long)head);
+
+	for (unsigned i = 0; i < trc_count; i++)
+		host_print("name,%u,%s\n", i + 1, trc_names[i].name);
+
+	for (uint32_t i = first; i < head; i++)
+	{
+		trc_rec_t *rec = &trc_buf.rec[i % TRC_SIZE];
+		host_print("rec,%lu,%u,%u,%u\n", (unsigned long)rec->time, rec->event, rec->task, rec->obj);
+	}
+
+	host_print("end\n");
+}
+
+#endif // TRC_SIZE
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <os.h>
+
+// size of the ring buffer (number of records, power of two)
+// the recorder is disabled when the size is 0, the macros expand to the bare kernel calls
+#ifndef TRC_SIZE
+#define TRC_SIZE 256
+#endif
+
+// maximum number of the named tasks and objects
+#ifndef TRC_NAMES
+#define TRC_NAMES 16
+#endif
+
+enum
+{
+	TrcSwitch,  // the task has been switched in
+	TrcGive,    // the object has been given
+	TrcTake,    // the object has been taken without waiting
+	TrcWait,    // the task starts waiting for the object
+	TrcWake,    // the task has been released from the wait
+	TrcTimeout, // the object couldn't be taken or the wait has failed
+	TrcTimer,   // the timer has expired
+};
+
+// every record is 8 bytes long, the fields are little-endian
+// time:  cycles of the DWT counter, or derived from the system time if the counter is not running
+// task:  id of the task that was running when the record was written (0: unnamed task)
+// obj:   id of the object (0: unnamed object)
+
+typedef struct
+{
+	uint32_t time;
+	uint8_t  event;
+	uint8_t  task;
+	uint16_t obj;
+} trc_rec_t;
+
+// the buffer (trc_buf) can be dumped from ram by the debugger as it is;
+// the oldest record is at index (head % size) if head > size, otherwise at index 0
+// the records are written by the tasks and the timer procedures only, never by the interrupt handlers
+
+typedef struct
+{
+	uint32_t  magic;    // 'TRC1'
+	uint32_t  freq;     // frequency of the time counter
+	uint32_t  size;     // TRC_SIZE
+	uint32_t  head;     // number of written records
+	trc_rec_t rec[TRC_SIZE ? TRC_SIZE : 1];
+} trc_buf_t;
+
+#define TRC_MAGIC 0x31435254 // 'TRC1'
+
+#if TRC_SIZE
+
+extern trc_buf_t trc_buf;
+
+void     trc_init( void );
+void     trc_name( const void *ptr, const char *name );
+void     trc_put ( unsigned event, const void *obj );
+unsigned trc_done( unsigned event, const void *obj, unsigned result );
+void     trc_dump( void );
+
+// instrumented wrappers of the kernel calls, e.g.:
+// TRC_GIVE(sem, sem_give(sem));
+// TRC_WAIT(msg, msg_wait(msg, &x, sizeof(x), NULL));
+// TRC_TAKE(evq, evq_take(evq, &x));
+// TRC_TIMER(tmr); (in the timer procedure)
+
+#define TRC_GIVE(obj, call)  (trc_put(TrcGive, obj), (call))
+#define TRC_TAKE(obj, call)  trc_done(TrcTake, obj, (call))
+#define TRC_WAIT(obj, call)  (trc_put(TrcWait, obj), trc_done(TrcWake, obj, (call)))
+#define TRC_TIMER(tmr)        trc_put(TrcTimer, tmr)
+
+#else
+
+#define trc_init()           ((void) 0)
+#define trc_name(ptr, name)  ((void) 0)
+#define trc_dump()           ((void) 0)
+
+#define TRC_GIVE(obj, call)  (call)
+#define TRC_TAKE(obj, call)  (call)
+#define TRC_WAIT(obj, call)  (call)
+#define TRC_TIMER(tmr)       ((void) 0)
+
+#endif
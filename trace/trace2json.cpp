@@ -0,0 +1,278 @@
+// host tool: converts the trace recorded by trace.c into the Chrome trace event format (JSON),
+// which can be opened by chrome://tracing or https://ui.perfetto.dev
+//
+// build: c++ -std=c++17 -O2 -o trace2json trace2json.cpp
+// usage: trace2json [file] > trace.json
+//
+// the input is either the text dump written by trc_dump() over semihosting
+// (other lines of the output are skipped), or the binary image of trc_buf dumped from ram
+// (e.g. gdb: dump binary value trace.bin trc_buf)
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum
+{
+	TrcSwitch,
+	TrcGive,
+	TrcTake,
+	TrcWait,
+	TrcWake,
+	TrcTimeout,
+	TrcTimer,
+};
+
+struct Record
+{
+	uint32_t time;
+	unsigned event;
+	unsigned task;
+	unsigned obj;
+};
+
+struct Trace
+{
+	uint32_t freq = 0;
+	std::map<unsigned, std::string> names;
+	std::vector<Record> records;
+};
+
+static constexpr uint32_t TRC_MAGIC = 0x31435254; // 'TRC1'
+
+static uint32_t get32( const std::string &data, size_t pos )
+{
+	uint32_t value = 0;
+	for (size_t i = 4; i-- > 0;)
+		value = (value << 8) | static_cast<uint8_t>(data[pos + i]);
+	return value;
+}
+
+// binary image of trc_buf_t (little-endian)
+static bool readBinary( const std::string &data, Trace &trace )
+{
+	if (data.size() < 16 || get32(data, 0) != TRC_MAGIC)
+		return false;
+
+	trace.freq = get32(data, 4);
+	uint32_t size = get32(data, 8);
+	uint32_t head = get32(data, 12);
+	if (size == 0 || data.size() < 16 + size_t(size) * 8)
+		return false;
+
+	uint32_t first = head > size ? head - size : 0;
+	for (uint32_t i = first; i < head; i++)
+	{
+		size_t pos = 16 + size_t(i % size) * 8;
+		uint32_t tag = get32(data, pos + 4);
+		trace.records.push_back({ get32(data, pos), tag & 0xFF, (tag >> 8) & 0xFF, tag >> 16 });
+	}
+	return true;
+}
+
+// text dump written by trc_dump()
+static bool readText( const std::string &data, Trace &trace )
+{
+	std::istringstream input(data);
+	std::string line;
+	bool found = false;
+
+	while (std::getline(input, line))
+	{
+		unsigned long time, size, head;
+		unsigned event, task, obj, id;
+		int pos = 0;
+
+		if (std::sscanf(line.c_str(), "trace,%lu,%lu,%lu", &time, &size, &head) == 3)
+		{
+			trace.freq = static_cast<uint32_t>(time);
+			found = true;
+		}
+		else
+		if (std::sscanf(line.c_str(), "name,%u,%n", &id, &pos) == 1 && pos > 0)
+		{
+			trace.names[id] = line.substr(pos);
+		}
+		else
+		if (std::sscanf(line.c_str(), "rec,%lu,%u,%u,%u", &time, &event, &task, &obj) == 4)
+		{
+			trace.records.push_back({ static_cast<uint32_t>(time), event, task, obj });
+		}
+		else
+		if (line == "end" && found)
+		{
+			break;
+		}
+	}
+	return found;
+}
+
+static std::string name( const Trace &trace, unsigned id, const char *unnamed )
+{
+	auto it = trace.names.find(id);
+	if (it != trace.names.end())
+		return it->second;
+	return id ? unnamed + std::to_string(id) : unnamed;
+}
+
+static std::string quote( const std::string &text )
+{
+	std::string result = "\"";
+	for (char c: text)
+	{
+		if (c == '"' || c == '\\') result += '\\';
+		if (static_cast<unsigned char>(c) >= ' ') result += c;
+	}
+	return result + "\"";
+}
+
+class Writer
+{
+	public:
+	Writer( std::ostream &out, uint32_t freq ): out_{out}, freq_{freq ? freq : 1} {}
+
+	~Writer() { out_ << "\n]}\n"; }
+
+	void begin()
+	{
+		out_ << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	}
+
+	void meta( unsigned tid, const std::string &thread )
+	{
+		event() << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"name\":\"thread_name\",\"args\":{\"name\":" << quote(thread) << "}}";
+	}
+
+	void slice( const char *ph, unsigned tid, uint64_t time, const std::string &what )
+	{
+		event() << "{\"ph\":\"" << ph << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << us(time) << ",\"name\":" << quote(what) << "}";
+	}
+
+	void instant( unsigned tid, uint64_t time, const std::string &what )
+	{
+		event() << "{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << us(time) << ",\"name\":" << quote(what) << "}";
+	}
+
+	void async( const char *ph, unsigned tid, uint64_t time, const std::string &what )
+	{
+		event() << "{\"ph\":\"" << ph << "\",\"cat\":\"wait\",\"id\":" << tid << ",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << us(time) << ",\"name\":" << quote(what) << "}";
+	}
+
+	private:
+	std::ostream &event()
+	{
+		out_ << (first_ ? "\n" : ",\n");
+		first_ = false;
+		return out_;
+	}
+
+	std::string us( uint64_t time ) const
+	{
+		char buf[32];
+		std::snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(time) * 1e6 / freq_);
+		return buf;
+	}
+
+	std::ostream &out_;
+	uint32_t freq_;
+	bool first_ = true;
+};
+
+static void convert( const Trace &trace, std::ostream &out )
+{
+	static const char *const action[] = { "switch", "give", "take", "wait", "wake", "timeout", "timer" };
+
+	Writer json(out, trace.freq);
+	json.begin();
+
+	std::set<unsigned> tasks;
+	for (const Record &rec: trace.records)
+		tasks.insert(rec.task);
+	for (unsigned task: tasks)
+		json.meta(task, name(trace, task, "task"));
+
+	std::map<unsigned, std::string> waiting; // the wait of the task that is in progress
+	uint64_t time = 0; // from the oldest record
+	uint32_t prev = trace.records.empty() ? 0 : trace.records.front().time;
+	bool running = false;
+	unsigned current = 0;
+
+	for (const Record &rec: trace.records)
+	{
+		time += static_cast<uint32_t>(rec.time - prev); // the 32-bit time counter wraps around
+		prev = rec.time;
+
+		std::string obj = name(trace, rec.obj, "obj");
+
+		switch (rec.event)
+		{
+		case TrcSwitch:
+			if (running)
+				json.slice("E", current, time, "run");
+			json.slice("B", rec.task, time, "run");
+			running = true;
+			current = rec.task;
+			break;
+
+		case TrcWait:
+			waiting[rec.task] = "wait " + obj;
+			json.async("b", rec.task, time, waiting[rec.task]);
+			break;
+
+		case TrcWake:
+		case TrcTimeout:
+			if (waiting.count(rec.task))
+			{
+				json.async("e", rec.task, time, waiting[rec.task]);
+				waiting.erase(rec.task);
+			}
+			if (rec.event == TrcTimeout)
+				json.instant(rec.task, time, "timeout " + obj);
+			break;
+
+		default:
+			if (rec.event < std::size(action))
+				json.instant(rec.task, time, std::string(action[rec.event]) + " " + obj);
+			break;
+		}
+	}
+
+	if (running)
+		json.slice("E", current, time, "run");
+}
+
+int main( int argc, char *argv[] )
+{
+	std::string data;
+
+	if (argc > 1)
+	{
+		std::ifstream file(argv[1], std::ios::binary);
+		if (!file)
+		{
+			std::cerr << "trace2json: cannot open " << argv[1] << "\n";
+			return 1;
+		}
+		data.assign(std::istreambuf_iterator<char>(file), {});
+	}
+	else
+	{
+		data.assign(std::istreambuf_iterator<char>(std::cin), {});
+	}
+
+	Trace trace;
+	if (!readBinary(data, trace) && !readText(data, trace))
+	{
+		std::cerr << "trace2json: no trace found\n";
+		return 1;
+	}
+
+	convert(trace, std::cout);
+}